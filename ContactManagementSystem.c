@@ -3,6 +3,7 @@
 #include <string.h> 
 #include <stdbool.h>
 #include <stdlib.h>
+#include <stdint.h>
 
 // ANSI escape sequences used for color coding text in terminal output
 const char *reset = "\033[0m";  // Reset to default color
@@ -12,11 +13,12 @@ const char *blue = "\033[1;34m"; // Blue color
 const char *green = "\033[1;32m"; // Green color
 
 // Struct representing a contact
-// Fields: name , phone number, email
+// Fields: name , phone number, email, phone number packed into an integer (see encodePhoneNum)
 struct Contact {
     char name[52];
     char phoneno[16];
     char email [52];
+    unsigned int phoneKey;
 };
 
 // Global variables: (Persists throughout the execution of the program until user exits)
@@ -28,6 +30,179 @@ int contactsSize = 100;
 // Initialised upon the starting of the program when all contacts are load from file
 struct Contact * contacts; // Acts as a "contact list" storing all saved contacts
 
+// Entry of the phone number index: packed phone number and the index of the contact in the contact list
+struct PhoneEntry {
+    unsigned int key;
+    int index;
+};
+
+// Phone number index: entries sorted by phone number, so that exact, prefix and range lookups on phone numbers
+// are binary searches instead of scanning all contacts
+// Rebuilt with radix sort on the first lookup after the contacts have been added, deleted, edited or sorted
+struct PhoneEntry * phoneIndex = NULL;
+int phoneIndexSize = 0; // Size of the dynamic memory allocated to store the index
+bool phoneIndexValid = false;
+
+// Called whenever the contacts are modified so the index is rebuilt before the next lookup
+void invalidatePhoneIndex(void) {
+    phoneIndexValid = false;
+}
+
+// Start of implementation of memory arenas
+// An arena hands out memory from large blocks by moving an offset forward, so most allocations never call malloc
+// Memory is not freed one allocation at a time, the whole arena is reset (reused) or freed at once
+struct ArenaBlock {
+    struct ArenaBlock * next; // Block that was filled before this one
+    size_t used;
+    size_t capacity;
+    // Followed by "capacity" bytes of memory
+};
+
+struct Arena {
+    struct ArenaBlock * head; // Block currently allocated from
+    char * last; // Latest allocation, the only one that can be grown in place
+    size_t blockSize; // Minimum size of a new block
+};
+
+#define ARENA_ALIGN 16 // Every allocation starts at a multiple of 16 bytes
+
+// Allocation counters (Displayed when the user exits)
+unsigned long systemAllocs = 0; // Number of calls to malloc
+unsigned long systemFrees = 0;  // Number of calls to free
+unsigned long arenaAllocs = 0;  // Number of allocations served by the arenas
+unsigned long arenaResets = 0;
+
+// Arenas used in the program
+struct Arena storeArena = {NULL, NULL, 100 * sizeof(struct Contact)};   // Contact list, grows as contacts are added
+struct Arena indexArena = {NULL, NULL, 100 * sizeof(struct PhoneEntry)}; // Phone number index
+struct Arena scratchArena = {NULL, NULL, 64 * 1024}; // Temporary memory of a menu operation, reset after each operation
+
+// Memory of a block starts right after the block header
+char * blockData(struct ArenaBlock * block) {
+    return (char *)(block + 1);
+}
+
+// Allocate a new block from the system and put it in front of the arena's blocks
+// Exits the program if the system has no memory left
+void addArenaBlock(struct Arena * arena, size_t capacity) {
+    struct ArenaBlock * block = malloc(sizeof(struct ArenaBlock) + capacity);
+    if (block == NULL) { // Every allocation of the program goes through here, there is nothing to fall back on
+        printf("%sOut of memory! Exiting program.\n%s", red, reset);
+        exit(1);
+    }
+    ++ systemAllocs;
+    (*block).next = (*arena).head;
+    (*block).used = 0;
+    (*block).capacity = capacity;
+    (*arena).head = block;
+}
+
+// Address where the next allocation of a block starts
+// Aligned relative to the real address so every allocation is aligned
+uintptr_t arenaNextStart(struct ArenaBlock * block) {
+    return ((uintptr_t)(blockData(block) + (*block).used) + ARENA_ALIGN - 1) & ~(uintptr_t)(ARENA_ALIGN - 1);
+}
+
+// Check if an allocation of "size" bytes fits in the block currently allocated from
+bool arenaHasRoom(struct Arena * arena, size_t size) {
+    struct ArenaBlock * block = (*arena).head;
+    return block != NULL && arenaNextStart(block) + size <= (uintptr_t)(blockData(block) + (*block).capacity);
+}
+
+// Allocate memory from an arena, a new block (at least double the size of the previous one) is added when full
+void * arenaAlloc(struct Arena * arena, size_t size) {
+    struct ArenaBlock * block = (*arena).head;
+    if (! arenaHasRoom(arena, size)) {
+        size_t capacity = (*arena).blockSize;
+        if (block != NULL && (*block).capacity * 2 > capacity) {
+            capacity = (*block).capacity * 2;
+        }
+        if (size + ARENA_ALIGN > capacity) {
+            capacity = size + ARENA_ALIGN;
+        }
+        addArenaBlock(arena, capacity);
+        block = (*arena).head;
+    }
+    uintptr_t start = arenaNextStart(block);
+    (*block).used = (start - (uintptr_t)blockData(block)) + size;
+    (*arena).last = (char *)start;
+    ++ arenaAllocs;
+    return (*arena).last;
+}
+
+// Grow an allocation to newSize bytes, keeping its content
+// The latest allocation is grown in place when the block has room, otherwise the content is copied to a new allocation
+// A new block is made twice as large as newSize, so the next doubling of the same allocation is done in place
+// If the old allocation was alone in its block, that block is returned to the system
+void * arenaGrow(struct Arena * arena, void * ptr, size_t oldSize, size_t newSize) {
+    struct ArenaBlock * block = (*arena).head;
+    if (ptr == NULL) {
+        return arenaAlloc(arena, newSize);
+    }
+    if (ptr == (*arena).last && (char *)ptr + newSize <= blockData(block) + (*block).capacity) {
+        (*block).used = ((char *)ptr - blockData(block)) + newSize;
+        ++ arenaAllocs;
+        return ptr;
+    }
+    bool alone = ptr == (*arena).last && (char *)ptr - blockData(block) < ARENA_ALIGN;
+    if (! arenaHasRoom(arena, newSize)) {
+        addArenaBlock(arena, newSize * 2 + ARENA_ALIGN);
+    }
+    void * newPtr = arenaAlloc(arena, newSize);
+    memcpy(newPtr, ptr, oldSize);
+    if (alone) { // The old block is now right after the new one
+        (*(*arena).head).next = (*block).next;
+        free(block);
+        ++ systemFrees;
+    }
+    return newPtr;
+}
+
+// Make all memory of an arena available again
+// If the arena needed more than one block, they are replaced by a single block as large as all of them together
+// so the same operation fits in one block next time without calling malloc
+void arenaReset(struct Arena * arena) {
+    struct ArenaBlock * block = (*arena).head;
+    if (block == NULL) {
+        return;
+    }
+    if ((*block).next != NULL) {
+        size_t total = 0;
+        while (block != NULL) {
+            struct ArenaBlock * next = (*block).next;
+            total += (*block).capacity;
+            free(block);
+            ++ systemFrees;
+            block = next;
+        }
+        (*arena).head = NULL;
+        addArenaBlock(arena, total);
+    }
+    (*(*arena).head).used = 0;
+    (*arena).last = NULL;
+    ++ arenaResets;
+}
+
+// Return all blocks of an arena to the system
+void arenaFree(struct Arena * arena) {
+    struct ArenaBlock * block = (*arena).head;
+    while (block != NULL) {
+        struct ArenaBlock * next = (*block).next;
+        free(block);
+        ++ systemFrees;
+        block = next;
+    }
+    (*arena).head = NULL;
+    (*arena).last = NULL;
+}
+
+// Display the allocation counters
+void printAllocStats(void) {
+    printf("Memory: %lu malloc call(s), %lu free call(s), %lu arena allocation(s), %lu scratch reset(s)\n",
+    systemAllocs, systemFrees, arenaAllocs, arenaResets);
+}
+// End of implementation of memory arenas
+
 // Validate phone number entered by user
 bool validatePhoneNum(char * phoneNum) {
     // Check length of phone number 
@@ -47,6 +222,19 @@ bool validatePhoneNum(char * phoneNum) {
     return true;
 }
 
+// Pack a valid phone number into an integer (Used for sorting and the phone number index)
+// Phone numbers are 10 or 11 digits beginning with "01", so the digits padded with '0' to 11 digits are below 2 * 10^9
+// Key = padded digits * 2 + 1 if the phone number has 11 digits, which fits in an unsigned int
+// Comparing two keys gives the same order as comparing the phone numbers with strcmp
+unsigned int encodePhoneNum(char * phoneNum) {
+    int length = strlen(phoneNum);
+    unsigned int key = 0;
+    for (int i = 0; i < 11; ++i) {
+        key = key * 10 + (i < length ? phoneNum[i] - '0' : 0);
+    }
+    return key * 2 + (length == 11);
+}
+
 // Validate name entered by user
 bool validateName(char * name) {
     // Check length of name
@@ -140,15 +328,20 @@ void rot47(char * data) {
     }
 }
 
-// Write a contact to file
-void writeToFile(struct Contact contact) {
-    FILE * f = fopen("contacts.txt", "a"); // Open file mode as append
+// Write a contact to a file that is already opened (Used by both the contact list and the change feed)
+void writeContact(FILE * f, struct Contact contact) {
     rot47(contact.name); // Ecrypt the name 
     fprintf(f, "%s\n", contact.name); // Save the encrypted data to file after encryption
     rot47(contact.phoneno);
     fprintf(f, "%s\n", contact.phoneno);
     rot47(contact.email);
     fprintf(f, "%s\n", contact.email);
+}
+
+// Write a contact to file
+void writeToFile(struct Contact contact) {
+    FILE * f = fopen("contacts.txt", "a"); // Open file mode as append
+    writeContact(f, contact);
     fclose(f); // Close file
 }
 
@@ -160,6 +353,151 @@ void removeNewline(struct Contact* contact) {
     (*contact).email[strcspn((*contact).email, "\n")] = '\0';
 }
 
+// Read a contact (three lines: name, phone number, email) from a file that is already opened
+// Returns false when the end of file is reached
+bool readContact(FILE * f, struct Contact * contact) {
+    if (fgets((*contact).name, sizeof((*contact).name), f) == NULL) {
+        return false;
+    }
+    fgets((*contact).phoneno, sizeof((*contact).phoneno), f);
+    fgets((*contact).email, sizeof((*contact).email), f);
+    removeNewline(contact); // Remove the newline character '\n' for each field of the contact read from file
+    // Decrypt the data
+    rot47((*contact).name);
+    rot47((*contact).phoneno);
+    rot47((*contact).email);
+    (*contact).phoneKey = encodePhoneNum((*contact).phoneno);
+    return true;
+}
+
+// Start of implementation of change feed
+// Every mutation (add, delete, edit, sort) is appended to "changes.txt" and stamped with a sequence number
+// A replica only needs the changes with a sequence number greater than the last one it has applied
+// Entry format: a header line "<sequence number> <operation>" followed by the contact(s) involved
+//   'A' (add)    --> new contact
+//   'D' (delete) --> deleted contact
+//   'E' (edit)   --> contact before the edit, then contact after the edit
+//   'S' (sort)   --> header carries the sort key as well: "<sequence number> S <n/p/e>"
+// The feed is never trimmed, it keeps growing with every change recorded
+// "changes_seq.txt" holds the latest sequence number and the size of "changes.txt" after that change,
+// so the program does not have to read the whole feed when it starts
+struct Change {
+    unsigned long seqNo;
+    char op;
+    char sortBy;
+    struct Contact oldContact;
+    struct Contact newContact;
+};
+
+// Sequence number of the latest change recorded (Loaded from "changes_seq.txt" when the program starts)
+unsigned long lastSeqNo = 0;
+
+// Write a change entry to a file that is already opened
+void writeChange(FILE * f, struct Change * change) {
+    if ((*change).op == 'S') {
+        fprintf(f, "%lu %c %c\n", (*change).seqNo, (*change).op, (*change).sortBy);
+        return;
+    }
+    fprintf(f, "%lu %c\n", (*change).seqNo, (*change).op);
+    if ((*change).op == 'D' || (*change).op == 'E') {
+        writeContact(f, (*change).oldContact);
+    }
+    if ((*change).op == 'A' || (*change).op == 'E') {
+        writeContact(f, (*change).newContact);
+    }
+}
+
+// Read a change entry from a file that is already opened
+// Returns false when the end of file is reached or the entry is malformed
+bool readChange(FILE * f, struct Change * change) {
+    char header[64];
+    if (fgets(header, sizeof(header), f) == NULL) {
+        return false;
+    }
+    if (sscanf(header, "%lu %c %c", &(*change).seqNo, &(*change).op, &(*change).sortBy) < 2) {
+        return false;
+    }
+    switch ((*change).op) {
+        case 'A':
+            return readContact(f, &(*change).newContact);
+        case 'D':
+            return readContact(f, &(*change).oldContact);
+        case 'E':
+            return readContact(f, &(*change).oldContact) && readContact(f, &(*change).newContact);
+        case 'S':
+            return true;
+    }
+    return false;
+}
+
+// Check if two contacts have exactly the same name, phone number and email
+bool sameContact(struct Contact * a, struct Contact * b) {
+    return strcmp((*a).name, (*b).name) == 0 &&
+    strcmp((*a).phoneno, (*b).phoneno) == 0 &&
+    strcmp((*a).email, (*b).email) == 0;
+}
+
+// Stamp a mutation with the next sequence number and append it to the change feed
+// oldContact/newContact may be NULL when the operation does not need them
+void logChange(char op, char sortBy, struct Contact * oldContact, struct Contact * newContact) {
+    struct Change change;
+    change.seqNo = lastSeqNo + 1;
+    change.op = op;
+    change.sortBy = sortBy;
+    if (oldContact != NULL) {
+        change.oldContact = *oldContact;
+    }
+    if (newContact != NULL) {
+        change.newContact = *newContact;
+    }
+    FILE * f = fopen("changes.txt", "a");
+    if (f == NULL) {
+        printf("%sUnable to record the change in changes.txt!\n%s", red, reset);
+        return;
+    }
+    writeChange(f, &change);
+    long feedSize = ftell(f); // Size of the feed including this change
+    fclose(f);
+    lastSeqNo = change.seqNo; // Only advance the sequence number once the change has been recorded
+    // If this file cannot be written, loadLastSeqNo reads the changes after the size saved previously instead
+    f = fopen("changes_seq.txt", "w");
+    if (f != NULL) {
+        fprintf(f, "%lu %ld\n", lastSeqNo, feedSize);
+        fclose(f);
+    }
+}
+
+// Called at the start of the program to find the sequence number of the latest change recorded
+// Only the changes recorded after the size saved in "changes_seq.txt" are read (none unless the program stopped
+// before it could update "changes_seq.txt"), the whole feed is only read if "changes_seq.txt" is missing
+void loadLastSeqNo(void) {
+    FILE * f = fopen("changes.txt", "r");
+    if (f == NULL) { // No changes recorded yet
+        return;
+    }
+    long offset = 0; // Position in the feed right after the change with sequence number lastSeqNo
+    FILE * seqFile = fopen("changes_seq.txt", "r");
+    if (seqFile != NULL) {
+        if (fscanf(seqFile, "%lu %ld", &lastSeqNo, &offset) != 2) {
+            lastSeqNo = 0;
+            offset = 0;
+        }
+        fclose(seqFile);
+    }
+    fseek(f, 0, SEEK_END);
+    if (ftell(f) < offset) { // The feed does not match "changes_seq.txt", read it from the beginning
+        lastSeqNo = 0;
+        offset = 0;
+    }
+    fseek(f, offset, SEEK_SET);
+    struct Change change;
+    while (readChange(f, &change)) {
+        lastSeqNo = change.seqNo;
+    }
+    fclose(f);
+}
+// End of implementation of change feed (Export and replay are implemented after the sorting feature)
+
 // Prompt user for either 'y' or 'n'(Used to decide whether to continue a specific operation)
 bool getDecision (void) {
     char buffer[1024];
@@ -220,7 +558,8 @@ void getEmail(char * buffer) {
 void resizeContacts() {
     if (noOfContacts == contactsSize) {
         contactsSize *= 2; // Double the size each time
-        contacts = realloc(contacts, contactsSize * sizeof(struct Contact)); // Reallocate dynamic memory to store all contacts saved
+        // Grow the memory storing all contacts saved (in place when the store arena has room, i.e. every other doubling)
+        contacts = arenaGrow(&storeArena, contacts, noOfContacts * sizeof(struct Contact), contactsSize * sizeof(struct Contact));
     }
 }
 
@@ -233,11 +572,14 @@ void addContacts() {
         strcpy(contact.name, buffer);  // Copy name to name field of the contact struct
         getPhoneNum(buffer); // Call getPhoneNum() to prompt user for a phone number
         strcpy(contact.phoneno, buffer); // Copy phone number to phone number field of the contact struct
+        contact.phoneKey = encodePhoneNum(contact.phoneno);
         getEmail(buffer); // Call getEmail() to prompt user for an email
         strcpy(contact.email, buffer); // Copy email to email field of the contact struct
         writeToFile(contact); // Write the newly added contact to file
+        logChange('A', ' ', NULL, &contact); // Record the addition in the change feed
         contacts[noOfContacts] = contact;   // Store the new contact to the contact list so it is visible to the program
         ++noOfContacts;   // Increament noOfContacts after a new contact is added
+        invalidatePhoneIndex();
         printf("%sContact succesfully added!\n%s", green, reset);
         resizeContacts(); // Resize the dynamic memory to store all contacts if needed
         printf("\nDo you want to continue adding?\n");
@@ -247,27 +589,20 @@ void addContacts() {
 // Called immediately at the start of the program to load all saved contacts from file to the program
 struct Contact * loadContactsFromFile(void) {
     FILE * f = fopen("contacts.txt", "r"); // Open file as read mode
-    // Allocate dynamic memory to store all contacts load from file
+    // Allocate memory from the store arena to store all contacts load from file
     // The pointer will be assigned to the global variable "contacts" after the function has been executed
-    struct Contact * contacts = malloc(contactsSize * sizeof(struct Contact)); 
+    struct Contact * contacts = arenaAlloc(&storeArena, contactsSize * sizeof(struct Contact)); 
     // Loop to load contacts from file by reading three lines each time for the name, phone number and email
-    // Loop until fgets() returns NULL indicating end of file
-    while (fgets(contacts[noOfContacts].name, sizeof(contacts[noOfContacts].name), f) != NULL) { 
-        fgets(contacts[noOfContacts].phoneno, sizeof(contacts[noOfContacts].phoneno), f);
-        fgets(contacts[noOfContacts].email, sizeof(contacts[noOfContacts].email), f);
-        removeNewline(contacts + noOfContacts); // Remove the newline character '\n' for each field of the contact read from file
-        // Decrypt the data
-        rot47(contacts[noOfContacts].name);
-        rot47(contacts[noOfContacts].phoneno);
-        rot47(contacts[noOfContacts].email);
+    // Loop until readContact() returns false indicating end of file
+    while (readContact(f, contacts + noOfContacts)) { // Read and decrypt the name, phone number and email
         ++ noOfContacts; // Increament noOfContacts each time a contact is load from file
         if (noOfContacts == contactsSize) { // Resize the dynamic memory allocated to store the contacts when needed
             contactsSize *= 2;
-            contacts = realloc(contacts, contactsSize * sizeof(struct Contact));
+            contacts = arenaGrow(&storeArena, contacts, noOfContacts * sizeof(struct Contact), contactsSize * sizeof(struct Contact));
         }
     }
     fclose(f); // Close file
-    return contacts; // Return pointer to dynamic memory storing all the contacts load from file
+    return contacts; // Return pointer to the memory storing all the contacts load from file
 }
 
 // Used to print out the user guidelines when the user requests to look at it
@@ -297,11 +632,23 @@ void userGuidelines(void) {
     printf("     - Allows the user to search for contacts based on any of the fields (name, phone number, or email).\n\n");
     printf("%s  6. Search Contacts by Partial Matches\n%s", orange, reset);
     printf("     - Allows the user to search for contacts based on a specific key.\n");
-    printf("     - For example, search for all contacts that begin with a certain letter.\n\n");
+    printf("     - For example, search for all contacts that begin with a certain letter.\n");
+    printf("     - Also allows the user to search for phone numbers beginning with a prefix (e.g. 0123),\n");
+    printf("       phone numbers within a range, and to count the phone numbers beginning with a prefix.\n\n");
     printf("%s  7. Edit Contacts\n%s", orange, reset);
     printf("     - Allows the user to search for a contact based on either name, phone number or email and edit it.\n\n");
-    printf("%s  8. Exit\n%s", orange, reset);
+    printf("%s  8. Sync Replica\n%s", orange, reset);
+    printf("     - Every add, delete, edit and sort is recorded in changes.txt with an increasing sequence number.\n");
+    printf("       changes.txt is never trimmed, it grows with every change recorded.\n");
+    printf("     - Allows the user to export only the changes after a given sequence number to delta.txt.\n");
+    printf("     - Allows the user to apply delta.txt to replica.txt, changes already applied are skipped.\n");
+    printf("       A delta.txt with missing changes is rejected and the replica is left unchanged.\n");
+    printf("     - The first line of replica.txt is the sequence number of the last change applied to it.\n");
+    printf("     - To start a replica from existing contacts, create replica.txt with the latest sequence number\n");
+    printf("       on the first line followed by the contents of contacts.txt.\n\n");
+    printf("%s  9. Exit\n%s", orange, reset);
     printf("     - Allows the user to exit from the program.\n");
+    printf("     - Displays how many memory allocations were made while the program was running.\n");
     printf("=====================================================================================================================\n");
 }
 
@@ -322,40 +669,33 @@ void displayContacts(struct Contact * contacts, int noOfContacts) {
 }
 
 // Start of implementation of sorting feature
-// Convert all characters of a string to lower case
-char * convertToLower(char * str) {
-    char * lowerCaseVersion = malloc((sizeof(char) * strlen(str)) + 1);
-    for (int i = 0; i < strlen(str); ++i) {
+// Convert all characters of a string to lower case and store them in lowerCaseVersion (at least as large as str)
+void convertToLower(char * str, char * lowerCaseVersion) {
+    int i;
+    for (i = 0; str[i] != '\0'; ++i) {
         lowerCaseVersion[i] = tolower(str[i]);
     }
-    lowerCaseVersion[strlen(str)] = '\0';
-    return lowerCaseVersion;
+    lowerCaseVersion[i] = '\0';
 }
 
 // Given the left halve and the right halve (of an array), compare the element at the begining of each halves
 // sortBy indicates sort by name or phone number or email
-// Use strcasecmp to compare two strings, either name, phone number or email depends on sortBy
+// Use strcasecmp to compare two strings, either name or email depends on sortBy
+// (Phone numbers are not sorted with merge sort, sortContacts uses radixSortByPhone instead)
 int cmp(struct Contact* leftHalve, struct Contact* rightHalve, char sortBy) {
     int result; // Stores the result of the comparison
-    char * leftHalveLower;
-    char * rightHalveLower;
+    char leftHalveLower[52]; // Same size as the name and email fields, so no dynamic memory is needed
+    char rightHalveLower[52];
     switch (sortBy) {
         case 'n': // Sort the contacts depending on user's choice
-            leftHalveLower = convertToLower((*leftHalve).name);    // Convert the name to lower case for case insensitive comparison
-            rightHalveLower = convertToLower((*rightHalve).name);
+            convertToLower((*leftHalve).name, leftHalveLower);    // Convert the name to lower case for case insensitive comparison
+            convertToLower((*rightHalve).name, rightHalveLower);
             result = strcmp(leftHalveLower, rightHalveLower);
-            free(leftHalveLower);  // Free the dynamic memory allocated to store the string converted to lower case
-            free(rightHalveLower);
-            break;
-        case 'p':
-            result = strcmp((*leftHalve).phoneno, (*rightHalve).phoneno);
             break;
         case 'e':
-            leftHalveLower = convertToLower((*leftHalve).email);
-            rightHalveLower = convertToLower((*rightHalve).email);
+            convertToLower((*leftHalve).email, leftHalveLower);
+            convertToLower((*rightHalve).email, rightHalveLower);
             result = strcmp(leftHalveLower, rightHalveLower);
-            free(leftHalveLower);
-            free(rightHalveLower);
             break;
     }
     return result;
@@ -364,8 +704,8 @@ int cmp(struct Contact* leftHalve, struct Contact* rightHalve, char sortBy) {
 // Merge two sorted halves into a larger sorted array
 // Given two halves, compare the item at the begining of each halve, add the smaller on to the array "merged"
 // Repeat until one halve is empty and copy all items on the remaining halve to array "merged"
-struct Contact* merge(char sortBy, struct Contact* leftHalve, struct Contact* rightHalve, int size1, int size2) {
-    struct Contact * merged = malloc(sizeof(struct Contact) * (size1 + size2));
+// "merged" is a buffer of at least size1 + size2 contacts shared by all levels of the recursion
+struct Contact* merge(char sortBy, struct Contact* leftHalve, struct Contact* rightHalve, int size1, int size2, struct Contact * merged) {
     struct Contact * startOfList = leftHalve;
     int totalSize = size1 + size2;
     struct Contact * startOfMerged = merged;
@@ -391,12 +731,12 @@ struct Contact* merge(char sortBy, struct Contact* leftHalve, struct Contact* ri
          memcpy(merged, leftHalve, size1 * sizeof(struct Contact));
     }
     memcpy(startOfList, startOfMerged, totalSize * sizeof(struct Contact));
-    free(startOfMerged);
     return startOfList;
 }
 
 // Main merge sort function
-struct Contact* mergesort(char sortBy, struct Contact* contacts, int size) {
+// "buffer" is temporary memory of at least "size" contacts used when merging
+struct Contact* mergesort(char sortBy, struct Contact* contacts, int size, struct Contact * buffer) {
     if (size == 1) {    // Base case: return the array itself if the size is one
         return contacts;
     }
@@ -404,14 +744,67 @@ struct Contact* mergesort(char sortBy, struct Contact* contacts, int size) {
     // Divide the array into two halves and call mergesort function recursively to sort each halve
     int size1 = size/2;    
     int size2 = size - size1;
-    struct Contact* leftHalve = mergesort(sortBy, contacts, size1);
-    struct Contact* rightHalve = mergesort(sortBy, contacts + (size/2), size2);
+    struct Contact* leftHalve = mergesort(sortBy, contacts, size1, buffer);
+    struct Contact* rightHalve = mergesort(sortBy, contacts + (size/2), size2, buffer);
     // Finally merge the sorted two halves
-    return merge(sortBy, leftHalve, rightHalve, size1, size2);
+    return merge(sortBy, leftHalve, rightHalve, size1, size2, buffer);
+}
+
+// Sort entries of (packed phone number, index of contact) using LSD radix sort in O(N)
+// Each pass is a stable counting sort on 8 bits of the key, 4 passes cover the whole unsigned int key
+// Entries with the same key keep their original relative order
+void radixSortPhoneEntries(struct PhoneEntry * entries, int size) {
+    struct PhoneEntry * buffer = arenaAlloc(&scratchArena, sizeof(struct PhoneEntry) * size);
+    struct PhoneEntry * from = entries;
+    struct PhoneEntry * to = buffer;
+    for (int shift = 0; shift < 32; shift += 8) {
+        int counts[257] = {0};
+        for (int i = 0; i < size; ++i) { // Count the occurences of each byte value
+            ++ counts[((from[i].key >> shift) & 0xFF) + 1];
+        }
+        for (int i = 0; i < 256; ++i) { // Turn the counts into the starting position of each byte value
+            counts[i + 1] += counts[i];
+        }
+        for (int i = 0; i < size; ++i) {
+            to[counts[(from[i].key >> shift) & 0xFF]++] = from[i];
+        }
+        struct PhoneEntry * swap = from; // The output of this pass is the input of the next pass
+        from = to;
+        to = swap;
+    }
+    // After an even number of passes the sorted entries are back in "entries"
+}
+
+// Sort the contacts by phone number with radix sort instead of merge sort
+void radixSortByPhone(struct Contact * contacts, int size) {
+    struct PhoneEntry * entries = arenaAlloc(&scratchArena, sizeof(struct PhoneEntry) * size);
+    struct Contact * sorted = arenaAlloc(&scratchArena, sizeof(struct Contact) * size);
+    for (int i = 0; i < size; ++i) {
+        entries[i].key = contacts[i].phoneKey;
+        entries[i].index = i;
+    }
+    radixSortPhoneEntries(entries, size);
+    for (int i = 0; i < size; ++i) { // Move each contact to its sorted position
+        sorted[i] = contacts[entries[i].index];
+    }
+    memcpy(contacts, sorted, sizeof(struct Contact) * size);
+}
+
+// Sort the contacts by name, phone number or email depending on sortBy
+// Temporary memory is taken from the scratch arena
+void sortContacts(char sortBy, struct Contact * contacts, int size) {
+    if (size == 0) {
+        return;
+    }
+    if (sortBy == 'p') {
+        radixSortByPhone(contacts, size);
+    } else {
+        mergesort(sortBy, contacts, size, arenaAlloc(&scratchArena, sizeof(struct Contact) * size));
+    }
 }
 
 // Main sort function (called by the main function in the menu if user selects this operation to be performed)
-// Calls the mergeSort function and write the sorted contacts to file in a new order
+// Calls the sortContacts function and write the sorted contacts to file in a new order
 void sort(void) {
     if (noOfContacts == 0) { // End the sorting operation directly if there are no contacts to be sorted
         printf("%sNo contacts stored. Unable to perform sorting operation!\n%s", red, reset);
@@ -432,7 +825,9 @@ void sort(void) {
             printf("%sInvalid option! Please enter again!\n%s", red, reset);
         }
     } 
-    mergesort(sortBy, contacts, noOfContacts); // Call mergesort function and start sorting the contacts based on the user's choice
+    sortContacts(sortBy, contacts, noOfContacts); // Start sorting the contacts based on the user's choice
+    invalidatePhoneIndex(); // The contacts have moved, the index of each contact is no longer valid
+    logChange('S', sortBy, NULL, NULL); // Record the new order in the change feed so replicas can sort the same way
     // Write the sorted contacts back to into the file (overwrites the previous entries)
     FILE * f = fopen("contacts.txt", "w");
     for (int i = 0; i < noOfContacts; ++i) {
@@ -444,6 +839,69 @@ void sort(void) {
 }
 // End of implementation of sorting feature
 
+// Start of implementation of phone number index
+// Build the index from the contacts saved if it is no longer valid
+void buildPhoneIndex(void) {
+    if (phoneIndexValid) {
+        return;
+    }
+    if (phoneIndexSize < contactsSize) { // Grow the index together with the contact list
+        phoneIndex = arenaGrow(&indexArena, phoneIndex, phoneIndexSize * sizeof(struct PhoneEntry), contactsSize * sizeof(struct PhoneEntry));
+        phoneIndexSize = contactsSize;
+    }
+    for (int i = 0; i < noOfContacts; ++i) {
+        phoneIndex[i].key = contacts[i].phoneKey;
+        phoneIndex[i].index = i;
+    }
+    radixSortPhoneEntries(phoneIndex, noOfContacts);
+    phoneIndexValid = true;
+}
+
+// Binary search for the position of the first entry in the index whose key is at least "key"
+int phoneLowerBound(unsigned long long key) {
+    int low = 0;
+    int high = noOfContacts;
+    while (low < high) {
+        int mid = low + (high - low) / 2;
+        if (phoneIndex[mid].key < key) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+// Find all entries whose key is between "low" and "high" (inclusive)
+// Returns the number of entries found, the position of the first one is stored in "first"
+int phoneRange(unsigned long long low, unsigned long long high, int * first) {
+    buildPhoneIndex();
+    *first = phoneLowerBound(low);
+    return phoneLowerBound(high + 1) - *first;
+}
+
+// Smallest and largest keys of the phone numbers beginning with a prefix of 1 to 11 digits
+// Unsigned long long is used because the largest key of a short prefix (e.g. "0") does not fit in an unsigned int
+void phonePrefixBounds(char * prefix, unsigned long long * low, unsigned long long * high) {
+    int length = strlen(prefix);
+    *low = 0;
+    *high = 0;
+    for (int i = 0; i < 11; ++i) {
+        *low = *low * 10 + (i < length ? prefix[i] - '0' : 0);  // Pad with '0' to get the smallest phone number
+        *high = *high * 10 + (i < length ? prefix[i] - '0' : 9); // Pad with '9' to get the largest phone number
+    }
+    *low = *low * 2 + (length == 11);
+    *high = *high * 2 + 1;
+}
+
+// Copy the contacts of the entries found in the index to "matchingContacts" (in phone number order)
+void collectPhoneRange(int first, int count, struct Contact * matchingContacts) {
+    for (int i = 0; i < count; ++i) {
+        matchingContacts[i] = contacts[phoneIndex[first + i].index];
+    }
+}
+// End of implementation of phone number index
+
 // Prompt user to input a contact field (name, phone number or email)
 void getContactField (char * buffer) {
     while (true) { // Loop until user has input a valid contact field
@@ -459,7 +917,7 @@ void getContactField (char * buffer) {
 
 // Allow user to search for specific contacts based on any field and delete one or all matching contacts (batch deletion)
 void deleteContacts(void) {
-    struct Contact temp[noOfContacts]; // Store all contacts that are not deleted temporarily 
+    struct Contact * temp = arenaAlloc(&scratchArena, sizeof(struct Contact) * noOfContacts); // Store all contacts that are not deleted temporarily 
     char field[55]; // Store the input field used to search for the contact to be deleted
     int count; // Store the number of contacts remaining (Also acts as index for temp array to store the contacts that are not deleted)
     do {
@@ -478,6 +936,7 @@ void deleteContacts(void) {
             strcmp(contacts[i].email, field) == 0) {  
                 // Inform the user that the contact has been deleted
                 printf("%s %s %s %shas been deleted successfully%s\n", contacts[i].name, contacts[i].phoneno, contacts[i].email, green, reset);
+                logChange('D', ' ', &contacts[i], NULL); // Record the deletion in the change feed
             } else {
                 // If the contact is not the contact to be deleted, store it in temp
                 temp[count] = contacts[i];
@@ -492,6 +951,7 @@ void deleteContacts(void) {
             // If there are contacts deleted, copy the remaining contacts in temp back into the memory allocated to store the contacts saved
             memcpy(contacts, temp, sizeof(struct Contact) * count); 
             noOfContacts = count; // Reset noOfContacts to count
+            invalidatePhoneIndex();
         }
         printf("\nDo you want to continue deleting?\n");
     } while(getDecision());   
@@ -508,14 +968,20 @@ void searchContacts(void){
     do {
         size = 0;
         printf("All contacts with matching fields will be displayed\n");
-        struct Contact * matchingContacts = malloc(sizeof(struct Contact) * noOfContacts); // Pointer to all matching contacts
+        arenaReset(&scratchArena); // Reuse the scratch memory of the previous search
+        struct Contact * matchingContacts = arenaAlloc(&scratchArena, sizeof(struct Contact) * noOfContacts); // Pointer to all matching contacts
         getContactField(field);
-        for (int i = 0; i < noOfContacts; ++i) {
-            if (strcmp(contacts[i].name, field) == 0 || 
-            strcmp(contacts[i].phoneno, field) == 0 || 
-            strcmp(contacts[i].email, field) == 0) {
-                matchingContacts[size] = contacts[i];
-                ++size;
+        if (validatePhoneNum(field)) { // A phone number can never be a valid name or email, so look it up in the phone number index
+            int first;
+            size = phoneRange(encodePhoneNum(field), encodePhoneNum(field), &first);
+            collectPhoneRange(first, size, matchingContacts);
+        } else {
+            for (int i = 0; i < noOfContacts; ++i) {
+                if (strcmp(contacts[i].name, field) == 0 || 
+                strcmp(contacts[i].email, field) == 0) {
+                    matchingContacts[size] = contacts[i];
+                    ++size;
+                }
             }
         }
         if (size == 0) { // If no contacts found, display the message to inform user
@@ -524,46 +990,162 @@ void searchContacts(void){
             printf("%sSuccessfully found all relevant contacts!\n%s", green, reset);
             displayContacts(matchingContacts, size); // Display all contacts found to user
         }
-        free(matchingContacts);
         printf("\nDo you want to continue searching?\n");
     } while (getDecision());
 }
 
 // Search by partial matching (Bonus feature)
+// Search for contacts whose names start with a key entered by user
+void partialMatchName(void) {
+    char key[1024];
+    int count = 0;
+    struct Contact * matchingContacts = arenaAlloc(&scratchArena, sizeof(struct Contact) * noOfContacts); // Store all matching contacts
+    while (true) { // Validate the key entered by user
+        printf("Enter a key of length 1 to 5\n");
+        scanf(" %[^\n]", key);
+        if (strlen(key) >= 1 && strlen(key) <=5) {
+            break;
+        }
+        printf("%sInvalid key! Please enter again\n!%s", red, reset);
+    }
+    // Loop through all contacts and find the matching ones
+    for (int i = 0; i < noOfContacts; ++i) {
+        if (strncmp(contacts[i].name, key, strlen(key)) == 0) {
+            matchingContacts[count] = contacts[i];
+            ++ count;
+        }
+    }
+    if (count == 0) { // If no contacts found, inform the user
+        printf("%sNo relevant contacts found!\n%s", red, reset);
+    } else { // Otherwise, call displayContacts to display all contacts found to user
+        printf("%sSuccessfully found all relevant contacts!\n%s", green, reset);
+        displayContacts(matchingContacts, count);
+    }
+}
+
+// Prompt user to enter the beginning of a phone number (1 to 11 digits) and store it in the buffer
+void getPhonePrefix(char * buffer) {
+    while (true) {
+        printf("Enter the beginning of a phone number (1 to 11 digits): \n");
+        scanf(" %[^\n]", buffer);
+        bool valid = strlen(buffer) >= 1 && strlen(buffer) <= 11;
+        for (int i = 0; valid && buffer[i] != '\0'; ++i) {
+            valid = isdigit(buffer[i]);
+        }
+        if (valid) {
+            return;
+        }
+        printf("%sInvalid input! Please enter again!\n%s", red, reset);
+    }
+}
+
+// Display the contacts whose phone numbers are between two keys (inclusive) using the phone number index
+void displayPhoneRange(unsigned long long low, unsigned long long high) {
+    int first;
+    int count = phoneRange(low, high, &first);
+    if (count == 0) {
+        printf("%sNo relevant contacts found!\n%s", red, reset);
+        return;
+    }
+    struct Contact * matchingContacts = arenaAlloc(&scratchArena, sizeof(struct Contact) * count);
+    collectPhoneRange(first, count, matchingContacts);
+    printf("%sSuccessfully found all relevant contacts!\n%s", green, reset);
+    displayContacts(matchingContacts, count);
+}
+
+// Search for contacts whose phone numbers start with a prefix entered by user
+void partialMatchPhone(void) {
+    char prefix[1024];
+    unsigned long long low, high;
+    getPhonePrefix(prefix);
+    phonePrefixBounds(prefix, &low, &high);
+    displayPhoneRange(low, high);
+}
+
+// Search for contacts whose phone numbers are between two phone numbers (or prefixes) entered by user
+// e.g. from "0123" to "0125" finds all phone numbers starting with 0123, 0124 or 0125
+void phoneRangeSearch(void) {
+    char from[1024];
+    char to[1024];
+    unsigned long long low, high, unused;
+    printf("Start of the range\n");
+    getPhonePrefix(from);
+    printf("End of the range\n");
+    getPhonePrefix(to);
+    phonePrefixBounds(from, &low, &unused);
+    phonePrefixBounds(to, &unused, &high);
+    if (low > high) {
+        printf("%sThe start of the range is after the end of the range!\n%s", red, reset);
+        return;
+    }
+    displayPhoneRange(low, high);
+}
+
+// Count the contacts whose phone numbers start with a prefix entered by user, broken down by the next digit
+void phonePrefixCounts(void) {
+    char prefix[1024];
+    unsigned long long low, high;
+    int first;
+    getPhonePrefix(prefix);
+    phonePrefixBounds(prefix, &low, &high);
+    printf("|%-12s|%-10s|\n", "Prefix", "Count");
+    printf("|%-12s|%-10d|\n", prefix, phoneRange(low, high, &first));
+    int length = strlen(prefix);
+    if (length == 11) { // Phone numbers have at most 11 digits, there is no next digit
+        return;
+    }
+    for (char digit = '0'; digit <= '9'; ++digit) {
+        prefix[length] = digit;
+        prefix[length + 1] = '\0';
+        phonePrefixBounds(prefix, &low, &high);
+        int count = phoneRange(low, high, &first);
+        if (count > 0) { // Only show the prefixes that have contacts
+            printf("|%-12s|%-10d|\n", prefix, count);
+        }
+    }
+}
+
 // Allow user to search for contacts by partial matching e.g. all contacts with name begining with a specific key
+// or all contacts with phone numbers begining with a specific prefix
 void partialMatching(void) {
     if (noOfContacts == 0) { // If no contacts stored, inform user and exit directly
         printf("%sNo contacts stored!\n%s", red, reset);
         return;
     }
+    char buffer[1024];
+    char option;
     do {
-        printf("This feature allows user to search for contacts by partial matching on name\n");
+        arenaReset(&scratchArena); // Reuse the scratch memory of the previous search
+        printf("This feature allows user to search for contacts by partial matching on name or phone number\n");
         printf("e.g. searching for contacts whose names start with a certain letter\n");
-        char key[1024];
-        int count = 0;
-        struct Contact * matchingContacts = malloc(sizeof(struct Contact) * noOfContacts); // Store all matching contacts
-        while (true) { // Validate the key entered by user
-            printf("Enter a key of length 1 to 5\n");
-            scanf(" %[^\n]", key);
-            if (strlen(key) >= 1 && strlen(key) <=5) {
+        while (true) { // Loop until the user inputs a valid option
+            printf("Select an option:\n");
+            printf("'n'--> name beginning with a key\n");
+            printf("'p'--> phone number beginning with a prefix\n");
+            printf("'r'--> phone number within a range\n");
+            printf("'c'--> count of phone numbers beginning with a prefix          choice: ");
+            scanf(" %[^\n]", buffer);
+            if (strlen(buffer) == 1 && (buffer[0] == 'n' || buffer[0] == 'p' || buffer[0] == 'r' || buffer[0] == 'c')) {
+                option = buffer[0];
                 break;
-            }
-            printf("%sInvalid key! Please enter again\n!%s", red, reset);
-        }
-        // Loop through all contacts and find the matching ones
-        for (int i = 0; i < noOfContacts; ++i) {
-            if (strncmp(contacts[i].name, key, strlen(key)) == 0) {
-                matchingContacts[count] = contacts[i];
-                ++ count;
+            } else {
+                printf("%sInvalid option! Please enter again!\n%s", red, reset);
             }
         }
-        if (count == 0) { // If no contacts found, inform the user
-            printf("%sNo relevant contacts found!\n%s", red, reset);
-        } else { // Otherwise, call displayContacts to display all contacts found to user
-            printf("%sSuccessfully found all relevant contacts!\n%s", green, reset);
-            displayContacts(matchingContacts, count);
+        switch (option) {
+            case 'n':
+                partialMatchName();
+                break;
+            case 'p':
+                partialMatchPhone();
+                break;
+            case 'r':
+                phoneRangeSearch();
+                break;
+            case 'c':
+                phonePrefixCounts();
+                break;
         }
-        free(matchingContacts);
         printf("\nDo you want to continue searching?\n");
     } while (getDecision());
 }
@@ -602,6 +1184,7 @@ void editContacts(void) {
                 if (edit) {
                     getPhoneNum(newData);
                     strcpy(contacts[i].phoneno, newData);
+                    contacts[i].phoneKey = encodePhoneNum(contacts[i].phoneno);
                 }
                 // Prompt the user if they want to edit the email and reset the email if necessary
                 printf("Do you want to edit the email?\n");
@@ -614,6 +1197,10 @@ void editContacts(void) {
                 printf("\033[1;32mContact successfully updated from\033[0m %s %s %s \033[1;32mto\033[0m %s %s %s\n", 
                 oldContact.name, oldContact.phoneno, oldContact.email, 
                 contacts[i].name, contacts[i].phoneno, contacts[i].email);
+                if (! sameContact(&oldContact, &contacts[i])) { // Nothing to record if no field has changed
+                    logChange('E', ' ', &oldContact, &contacts[i]); // Record the edit in the change feed
+                    invalidatePhoneIndex();
+                }
                 found = true;
             }
             writeToFile(contacts[i]);  
@@ -627,6 +1214,218 @@ void editContacts(void) {
     } while (getDecision());
 }
 
+// Start of implementation of incremental sync to a replica
+// Export all changes with a sequence number greater than sinceSeqNo from "changes.txt" to "delta.txt"
+void exportChanges(unsigned long sinceSeqNo) {
+    FILE * feed = fopen("changes.txt", "r");
+    if (feed == NULL) {
+        printf("%sNo changes recorded yet!\n%s", red, reset);
+        return;
+    }
+    FILE * delta = fopen("delta.txt", "w");
+    if (delta == NULL) {
+        printf("%sUnable to write the changes to delta.txt!\n%s", red, reset);
+        fclose(feed);
+        return;
+    }
+    struct Change change;
+    int count = 0; // Number of changes exported
+    while (readChange(feed, &change)) {
+        if (change.seqNo > sinceSeqNo) {
+            writeChange(delta, &change);
+            ++ count;
+        }
+    }
+    fclose(feed);
+    fclose(delta);
+    printf("%s%d change(s) after #%lu exported to delta.txt\n%s", green, count, sinceSeqNo, reset);
+}
+
+// Load all contacts of the replica ("replica.txt") into the scratch arena
+// The first line of the replica is the sequence number of the last change applied to it, followed by the contacts
+// The number of contacts and the size of the memory allocated are returned through count and size
+struct Contact * loadReplica(int * count, int * size) {
+    char header[64];
+    *count = 0;
+    *size = 100;
+    struct Contact * replica = arenaAlloc(&scratchArena, *size * sizeof(struct Contact));
+    FILE * f = fopen("replica.txt", "r");
+    if (f == NULL) { // The replica has not been created yet, start from an empty contact list
+        return replica;
+    }
+    fgets(header, sizeof(header), f); // Skip the sequence number
+    while (readContact(f, replica + *count)) {
+        ++ *count;
+        if (*count == *size) {
+            *size *= 2;
+            replica = arenaGrow(&scratchArena, replica, *count * sizeof(struct Contact), *size * sizeof(struct Contact));
+        }
+    }
+    fclose(f);
+    return replica;
+}
+
+// Replay a single change on the replica loaded in memory
+void applyChange(struct Change * change, struct Contact ** replica, int * count, int * size) {
+    switch ((*change).op) {
+        case 'A':
+            (*replica)[*count] = (*change).newContact;
+            ++ *count;
+            if (*count == *size) {
+                *size *= 2;
+                *replica = arenaGrow(&scratchArena, *replica, *count * sizeof(struct Contact), *size * sizeof(struct Contact));
+            }
+            break;
+        case 'D':
+            for (int i = 0; i < *count; ++i) { // Remove the first contact identical to the deleted one
+                if (sameContact(*replica + i, &(*change).oldContact)) {
+                    memmove(*replica + i, *replica + i + 1, (*count - i - 1) * sizeof(struct Contact));
+                    -- *count;
+                    break;
+                }
+            }
+            break;
+        case 'E':
+            for (int i = 0; i < *count; ++i) { // Replace the first contact identical to the contact before the edit
+                if (sameContact(*replica + i, &(*change).oldContact)) {
+                    (*replica)[i] = (*change).newContact;
+                    break;
+                }
+            }
+            break;
+        case 'S':
+            sortContacts((*change).sortBy, *replica, *count);
+            break;
+    }
+}
+
+// Sequence number of the last change applied to the replica (0 if no change has been applied yet)
+unsigned long loadReplicaSeqNo(void) {
+    unsigned long replicaSeqNo = 0;
+    FILE * f = fopen("replica.txt", "r");
+    if (f != NULL) { // Only the first line of the replica is read
+        fscanf(f, "%lu", &replicaSeqNo);
+        fclose(f);
+    }
+    return replicaSeqNo;
+}
+
+// Check that the changes in the delta not yet applied start right after replicaSeqNo and have no missing sequence number
+// Otherwise a change would be skipped and could never be applied later
+bool checkDelta(FILE * delta, unsigned long replicaSeqNo) {
+    struct Change change;
+    unsigned long expected = replicaSeqNo + 1;
+    while (readChange(delta, &change)) {
+        if (change.seqNo <= replicaSeqNo && expected == replicaSeqNo + 1) { // Changes already applied before the new ones
+            continue;
+        }
+        if (change.seqNo != expected) {
+            printf("%sdelta.txt is missing change #%lu (found #%lu)! Export the changes since #%lu again.\n%s",
+            red, expected, change.seqNo, replicaSeqNo, reset);
+            return false;
+        }
+        ++ expected;
+    }
+    rewind(delta); // Go back to the first change so it can be applied
+    return true;
+}
+
+// Replay the changes in "delta.txt" on the replica ("replica.txt")
+// The sequence number of the last change applied is the first line of the replica so changes already applied are skipped
+// The new replica is written to "replica.tmp" and then renamed over "replica.txt", so the contacts and the sequence number
+// are replaced together and a failure part way through leaves the previous replica as it was
+void applyChanges(void) {
+    FILE * delta = fopen("delta.txt", "r");
+    if (delta == NULL) {
+        printf("%sNo delta.txt found! Export the changes first.\n%s", red, reset);
+        return;
+    }
+    unsigned long replicaSeqNo = loadReplicaSeqNo();
+    if (! checkDelta(delta, replicaSeqNo)) { // Leave the replica untouched
+        fclose(delta);
+        return;
+    }
+    int count;
+    int size;
+    struct Contact * replica = loadReplica(&count, &size);
+    int applied = 0; // Number of changes applied
+    struct Change change;
+    while (readChange(delta, &change)) {
+        if (change.seqNo <= replicaSeqNo) { // Skip the changes the replica has already applied
+            continue;
+        }
+        applyChange(&change, &replica, &count, &size);
+        replicaSeqNo = change.seqNo;
+        ++ applied;
+    }
+    fclose(delta);
+    if (applied == 0) {
+        printf("%sNo new changes in delta.txt, replica is still at #%lu\n%s", green, replicaSeqNo, reset);
+        return;
+    }
+    FILE * f = fopen("replica.tmp", "w");
+    if (f == NULL) {
+        printf("%sUnable to write to replica.tmp!\n%s", red, reset);
+        return;
+    }
+    fprintf(f, "%lu\n", replicaSeqNo);
+    for (int i = 0; i < count; ++i) {
+        writeContact(f, replica[i]);
+    }
+    if (fclose(f) != 0 || rename("replica.tmp", "replica.txt") != 0) {
+        printf("%sUnable to write to replica.txt! The replica is unchanged.\n%s", red, reset);
+        remove("replica.tmp");
+        return;
+    }
+    printf("%s%d change(s) applied, replica is now at #%lu\n%s", green, applied, replicaSeqNo, reset);
+}
+
+// Allow user to export the changes since a sequence number or to apply the exported changes to the replica
+void syncReplica(void) {
+    char buffer[1024];
+    char option;
+    do {
+        arenaReset(&scratchArena); // Reuse the scratch memory of the previous sync
+        printf("Latest change recorded: #%lu\n", lastSeqNo);
+        while (true) { // Loop until the user inputs a valid option
+            printf("Select an option:\n");
+            printf("'e'--> export changes since a sequence number to delta.txt\n");
+            printf("'a'--> apply delta.txt to replica.txt          choice: ");
+            scanf(" %[^\n]", buffer);
+            if (strlen(buffer) == 1 && (buffer[0] == 'e' || buffer[0] == 'a')) {
+                option = buffer[0];
+                break;
+            } else {
+                printf("%sInvalid option! Please enter again!\n%s", red, reset);
+            }
+        }
+        if (option == 'e') {
+            char * end;
+            unsigned long replicaSeqNo = loadReplicaSeqNo();
+            while (true) { // Loop until the user inputs a valid sequence number
+                printf("Enter the sequence number to export changes after (0 for all changes, 'r' for #%lu applied to the replica): ", replicaSeqNo);
+                scanf(" %[^\n]", buffer);
+                if (strcmp(buffer, "r") == 0) { // Default: everything the replica has not applied yet
+                    sprintf(buffer, "%lu", replicaSeqNo);
+                    break;
+                }
+                if (isdigit(buffer[0])) {
+                    strtoul(buffer, &end, 10);
+                    if (*end == '\0') {
+                        break;
+                    }
+                }
+                printf("%sInvalid sequence number! Please enter again!\n%s", red, reset);
+            }
+            exportChanges(strtoul(buffer, NULL, 10));
+        } else {
+            applyChanges();
+        }
+        printf("\nDo you want to continue syncing?\n");
+    } while (getDecision());
+}
+// End of implementation of incremental sync to a replica
+
 // Called to clear the input buffer
 void clearInputBuffer() {
     int c;
@@ -638,6 +1437,7 @@ void clearInputBuffer() {
 // Only stop when the user chooses to exit
 int main(void) {
     contacts = loadContactsFromFile();
+    loadLastSeqNo(); // Continue the sequence numbers from the latest change recorded
     char choice;
     char buffer[1024];
     do {
@@ -652,14 +1452,15 @@ int main(void) {
         printf("%s 5. Search Contacts                     %s\n", orange, reset);
         printf("%s 6. Search by Partial Matches           %s\n", orange, reset);
         printf("%s 7. Edit Contacts                       %s\n", orange, reset);
-        printf("%s 8. Exit                                %s\n", orange, reset);
+        printf("%s 8. Sync Replica                        %s\n", orange, reset);
+        printf("%s 9. Exit                                %s\n", orange, reset);
         printf("========================================\n");
 
         // Loop until the user input a valid choice
         while (true) {
-            printf("Enter your choice (0 to 8): ");
+            printf("Enter your choice (0 to 9): ");
             scanf(" %[^\n]", buffer); 
-            if (strlen(buffer) == 1 && buffer[0] >= '0' && buffer[0] <= '8') {
+            if (strlen(buffer) == 1 && buffer[0] >= '0' && buffer[0] <= '9') {
                 choice = buffer[0];
                 break;
             } else {
@@ -695,10 +1496,18 @@ int main(void) {
             editContacts();
             break;
         case '8':
+            syncReplica();
+            break;
+        case '9':
+            printAllocStats();
             printf("Exiting program.\n");
             break;
         }
-    } while (choice != '8');
-    free(contacts);
+        arenaReset(&scratchArena); // Temporary memory of the operation is no longer needed
+    } while (choice != '9');
+    // Return all memory of the arenas to the system
+    arenaFree(&storeArena);
+    arenaFree(&indexArena);
+    arenaFree(&scratchArena);
     return 0;
 }
\ No newline at end of file